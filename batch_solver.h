@@ -0,0 +1,228 @@
+//
+// Linear System Solver version 1.1.a
+// Created by Seehait Chockthanyawat
+//
+
+#ifndef SIC_BATCH_SOLVER_INCLUDED
+#define SIC_BATCH_SOLVER_INCLUDED
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "fraction.h"
+
+namespace sic
+{
+
+// solve many square systems of the same size at once, entry (i, j) of all systems is contiguous
+// only systems with a unique solution are solved, the others are left to the caller to classify
+class batch_solver
+{
+protected:
+	// every entry is an integer of at most value_limit, so a product of two entries is below 2^52 and
+	// the integers are exact in double, which unlike long long has a SIMD division for the Bareiss step
+	static constexpr double value_limit = 67108864.0; // 2^26
+
+	size_t total_var;
+	size_t total_system;
+
+	// integer augmented matrices in structure-of-arrays layout: lane[row][col][lane],
+	// each row is scaled by the least common denominator of its entries
+	std::vector<std::vector<std::vector<double> > > lane;
+	std::vector<std::vector<long long> > row_scale;
+
+	// pivot of the previous step of each lane, every entry after a step is divisible by it (Bareiss)
+	std::vector<double> previous;
+
+	// largest entry of each lane, a lane beyond value_limit is no longer exact
+	std::vector<double> largest;
+
+	// system held by each lane and lane of each system, dropped systems are moved behind the active lanes of their block
+	std::vector<size_t> lane_system;
+	std::vector<size_t> system_lane;
+	std::vector<char> lane_solved;
+
+	// lanes reduced together, a block of 4x4 systems stays in the L1 cache through every step
+	static const size_t block_size = 256;
+
+	// exchange two lanes, used to move a dropped system out of the active lanes
+	void swap_lane(size_t first_lane, size_t second_lane)
+	{
+		for (size_t row_pointer = 0; row_pointer < total_var; row_pointer++)
+		{
+			for (size_t col_pointer = 0; col_pointer <= total_var; col_pointer++)
+			{
+				std::swap(lane[row_pointer][col_pointer][first_lane], lane[row_pointer][col_pointer][second_lane]);
+			}
+		}
+		std::swap(previous[first_lane], previous[second_lane]);
+		std::swap(largest[first_lane], largest[second_lane]);
+		std::swap(lane_system[first_lane], lane_system[second_lane]);
+	}
+
+	// move lanes in [begin, end) without a pivot in target_col or with a too large entry behind the others,
+	// return the new end of the active lanes
+	size_t drop_lane(size_t target_col, size_t begin, size_t end)
+	{
+		size_t lane_pointer = begin;
+		while (lane_pointer < end)
+		{
+			if (lane[target_col][target_col][lane_pointer] == 0 || largest[lane_pointer] > value_limit)
+			{
+				end--;
+				swap_lane(lane_pointer, end);
+			}
+			else lane_pointer++;
+		}
+		return end;
+	}
+
+	// fraction-free Gauss-Jordan elimination of the lanes in [begin, end), return the new end of the active lanes
+	size_t solve_block(size_t begin, size_t end, std::vector<double>& factor)
+	{
+		for (size_t col_pointer = 0; col_pointer < total_var; col_pointer++)
+		{
+			// pull the first row below with a nonzero entry into the pivot row of every lane whose pivot is zero,
+			// the pivot column is blended last since it decides which lanes swap
+			for (size_t row_pointer = col_pointer + 1; row_pointer < total_var; row_pointer++)
+			{
+				const double* pivot = lane[col_pointer][col_pointer].data();
+				const double* candidate = lane[row_pointer][col_pointer].data();
+				bool is_any_swap = false;
+				for (size_t lane_pointer = begin; lane_pointer < end; lane_pointer++)
+				{
+					is_any_swap |= (pivot[lane_pointer] == 0) & (candidate[lane_pointer] != 0);
+				}
+				if (!is_any_swap) continue;
+
+				for (size_t offset = 1; offset <= total_var - col_pointer + 1; offset++)
+				{
+					size_t target_col = col_pointer + offset;
+					if (target_col > total_var) target_col = col_pointer;
+					double* first = lane[col_pointer][target_col].data();
+					double* second = lane[row_pointer][target_col].data();
+					for (size_t lane_pointer = begin; lane_pointer < end; lane_pointer++)
+					{
+						bool is_swap = (pivot[lane_pointer] == 0) & (candidate[lane_pointer] != 0);
+						double first_value = first[lane_pointer];
+						double second_value = second[lane_pointer];
+						first[lane_pointer] = is_swap ? second_value : first_value;
+						second[lane_pointer] = is_swap ? first_value : second_value;
+					}
+				}
+			}
+
+			// keep the active lanes packed, so the loops below never test for dropped systems
+			end = drop_lane(col_pointer, begin, end);
+
+			// row = (pivot * row - factor * pivot_row) / previous for every other row, the division is exact
+			const double* pivot = lane[col_pointer][col_pointer].data();
+			const double* last_pivot = previous.data();
+			double* size = largest.data();
+			for (size_t row_pointer = 0; row_pointer < total_var; row_pointer++)
+			{
+				if (row_pointer == col_pointer) continue;
+
+				std::copy(lane[row_pointer][col_pointer].begin() + begin, lane[row_pointer][col_pointer].begin() + end, factor.begin() + begin);
+				for (size_t target_col = 0; target_col <= total_var; target_col++)
+				{
+					double* target = lane[row_pointer][target_col].data();
+					const double* source = lane[col_pointer][target_col].data();
+					for (size_t lane_pointer = begin; lane_pointer < end; lane_pointer++)
+					{
+						double value = (pivot[lane_pointer] * target[lane_pointer] - factor[lane_pointer] * source[lane_pointer]) / last_pivot[lane_pointer];
+						target[lane_pointer] = value;
+						size[lane_pointer] = std::fabs(value) > size[lane_pointer] ? std::fabs(value) : size[lane_pointer];
+					}
+				}
+			}
+			std::copy(lane[col_pointer][col_pointer].begin() + begin, lane[col_pointer][col_pointer].begin() + end, previous.begin() + begin);
+		}
+
+		// the last step can still overflow, its pivot row is unchanged so only the size is checked again
+		if (total_var > 0) end = drop_lane(total_var - 1, begin, end);
+		return end;
+	}
+public:
+	// default constructor
+	batch_solver() : total_var(0), total_system(0) { }
+
+	// modifier
+	// start a batch of total systems with n variable(s) and n equation(s) each
+	void resize(const size_t n, const size_t total)
+	{
+		total_var = n;
+		total_system = total;
+		lane.assign(n, std::vector<std::vector<double> >(n + 1, std::vector<double>(total, 0)));
+		row_scale.assign(n, std::vector<long long>(total, 1));
+		previous.assign(total, 1);
+		largest.assign(total, 0);
+		lane_system.resize(total);
+		system_lane.resize(total);
+		lane_solved.assign(total, 0);
+		for (size_t pointer = 0; pointer < total; pointer++) lane_system[pointer] = system_lane[pointer] = pointer;
+	}
+
+	// entry of the augmented matrix of the target system, col = n is the right-hand side
+	void set_entry(const size_t system, const size_t row, const size_t col, const fraction& entry)
+	{
+		long long& scale = row_scale[row][system];
+		long long bottom = entry.get_bottom();
+		if (bottom == 0 || largest[system] > value_limit)
+		{
+			largest[system] = 2 * value_limit;
+			return;
+		}
+
+		// bring the row to the common denominator of its entries so far
+		long long factor = bottom / gcd(scale, bottom);
+		if (factor != 1)
+		{
+			scale *= factor;
+			for (size_t col_pointer = 0; col_pointer <= total_var; col_pointer++) lane[row][col_pointer][system] *= factor;
+		}
+		lane[row][col][system] = (double) entry.get_top() * (scale / bottom);
+
+		for (size_t col_pointer = 0; col_pointer <= total_var; col_pointer++)
+		{
+			largest[system] = std::max(largest[system], std::fabs(lane[row][col_pointer][system]));
+		}
+		if (scale > value_limit) largest[system] = 2 * value_limit;
+	}
+
+	// reduce every system to a diagonal form with fraction-free Gauss-Jordan elimination,
+	// a system without a pivot in some column or with a too large entry is dropped
+	void solve()
+	{
+		std::vector<double> factor(total_system);
+		lane_solved.assign(total_system, 0);
+		for (size_t begin = 0; begin < total_system; begin += block_size)
+		{
+			size_t end = solve_block(begin, std::min(total_system, begin + block_size), factor);
+			for (size_t lane_pointer = begin; lane_pointer < end; lane_pointer++) lane_solved[lane_pointer] = 1;
+		}
+
+		for (size_t lane_pointer = 0; lane_pointer < total_system; lane_pointer++)
+		{
+			system_lane[lane_system[lane_pointer]] = lane_pointer;
+		}
+	}
+
+	// access
+	// true when the target system has a unique solution that was found exactly
+	bool is_solved(const size_t system) const
+	{
+		return lane_solved[system_lane[system]];
+	}
+
+	// variable of the target system, only valid when it is solved, every diagonal entry is the last pivot
+	fraction get_solution(const size_t system, const size_t var) const
+	{
+		size_t target_lane = system_lane[system];
+		return fraction((int) lane[var][total_var][target_lane], (int) lane[var][var][target_lane]);
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include <iostream>
+#include "batch_solver.h"
+
+using namespace std;
+
+int main()
+{
+	// x + y = 3, x - y = 1 has a unique solution
+	// x + y = 3, 2x + 2y = 6 is singular but consistent
+	// c3 = 0, -c3 = -4 is inconsistent and singular in the first columns
+	// 2x - y = 0, x + y = 3 needs a row swap in the second system of the same size
+	int system[4][4][5] = {
+		{ { 1, 1, 0, 0, 3 }, { 1, -1, 0, 0, 1 }, { 0, 0, 1, 0, 0 }, { 0, 0, 0, 1, 0 } },
+		{ { 1, 1, 0, 0, 3 }, { 2, 2, 0, 0, 6 }, { 0, 0, 1, 0, 0 }, { 0, 0, 0, 1, 0 } },
+		{ { 0, 0, 0, 1, 0 }, { 0, 0, 0, -1, -4 }, { 2, -3, 0, 0, 4 }, { 0, 0, 0, 2, 0 } },
+		{ { 0, 2, -1, 0, 0 }, { 1, 0, 1, 0, 3 }, { 0, 0, 0, 3, 1 }, { 1, 0, 0, 0, 1 } }
+	};
+
+	sic::batch_solver solver;
+	solver.resize(4, 4);
+	for (size_t system_pointer = 0; system_pointer < 4; system_pointer++)
+	{
+		for (size_t row_pointer = 0; row_pointer < 4; row_pointer++)
+		{
+			for (size_t col_pointer = 0; col_pointer < 5; col_pointer++)
+			{
+				solver.set_entry(system_pointer, row_pointer, col_pointer, sic::fraction(system[system_pointer][row_pointer][col_pointer], 1));
+			}
+		}
+	}
+	solver.solve();
+
+	for (size_t system_pointer = 0; system_pointer < 4; system_pointer++)
+	{
+		cout << solver.is_solved(system_pointer) << ":";
+		for (size_t var_pointer = 0; var_pointer < 4 && solver.is_solved(system_pointer); var_pointer++)
+		{
+			cout << " ";
+			solver.get_solution(system_pointer, var_pointer).print();
+		}
+		cout << endl;
+	}
+	return 0;
+}
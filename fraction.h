@@ -8,10 +8,28 @@
 
 #include <iostream>
 #include <algorithm>
+#include <type_traits>
 
 namespace sic
 {
 
+// gcd of |a| and |b|, gcd(a, 0) = |a|
+// Euclid's algorithm, the binary (Stein) gcd is no faster on small operands and slower on large ones, see fraction_bench.cpp
+template <typename T>
+T gcd(T a, T b)
+{
+	typedef typename std::make_unsigned<T>::type unsigned_type;
+	unsigned_type u = a < 0 ? unsigned_type(0) - (unsigned_type) a : (unsigned_type) a;
+	unsigned_type v = b < 0 ? unsigned_type(0) - (unsigned_type) b : (unsigned_type) b;
+	while (v != 0)
+	{
+		unsigned_type remainder = u % v;
+		u = v;
+		v = remainder;
+	}
+	return (T) u;
+}
+
 class fraction
 {
 protected:
@@ -22,7 +40,7 @@ protected:
 	// simplify make the simplest fraction
 	void simplify()
 	{
-		int factor = std::__gcd(top, bottom);
+		int factor = gcd(top, bottom);
 		if (factor != 0)
 		{
 			top /= factor;
@@ -34,6 +52,41 @@ protected:
 			bottom *= -1;
 		}
 	}
+
+	// make a fraction from parts that are already in the lowest terms, only the sign is fixed
+	static fraction make_reduced(const int t, const int b)
+	{
+		fraction result;
+		result.top = b < 0 ? -t : t;
+		result.bottom = b < 0 ? -b : b;
+		return result;
+	}
+
+	// sum of this and sign * other, cross-cancelled by the gcd of the denominators (Knuth 4.5.1)
+	fraction add(const fraction& other, const int sign) const
+	{
+		if (bottom == 0 || other.bottom == 0) return fraction(top * other.bottom + sign * other.top * bottom, bottom * other.bottom);
+
+		int factor = gcd(bottom, other.bottom);
+		if (factor == 1) return make_reduced(top * other.bottom + sign * other.top * bottom, bottom * other.bottom);
+
+		int t = top * (other.bottom / factor) + sign * other.top * (bottom / factor);
+		if (t == 0) return fraction();
+		int other_factor = gcd(t, factor);
+		return make_reduced(t / other_factor, (bottom / factor) * (other.bottom / other_factor));
+	}
+
+	// product of this and other_top/other_bottom, cross-cancelled before multiplying
+	fraction multiply(const int other_top, const int other_bottom) const
+	{
+		if (bottom == 0 || other_bottom == 0) return fraction(top * other_top, bottom * other_bottom);
+		if (top == 0 || other_top == 0) return fraction();
+
+		int factor = gcd(top, other_bottom);
+		int other_factor = gcd(other_top, bottom);
+		if (factor == 1 && other_factor == 1) return make_reduced(top * other_top, bottom * other_bottom);
+		return make_reduced((top / factor) * (other_top / other_factor), (bottom / other_factor) * (other_bottom / factor));
+	}
 public:
 	// default constructor
 	fraction() : top(0), bottom(1) { }
@@ -58,86 +111,69 @@ public:
 		return *this;
 	}
 
-	bool operator==(const fraction& other)
+	bool operator==(const fraction& other) const
 	{
 		return other.top == top && other.bottom == bottom;
 	}
 
-	bool operator!=(const fraction& other)
+	bool operator!=(const fraction& other) const
 	{
 		return other.top != top || other.bottom != bottom;
 	}
 
-	bool operator<(const fraction& other)
+	// both denominators are positive, so cross multiplication keeps the order
+	bool operator<(const fraction& other) const
 	{
-		fraction factor(other);
-		return get_float_value() < factor.get_float_value();
+		return (long long) top * other.bottom < (long long) other.top * bottom;
 	}
 
-	bool operator>(const fraction& other)
+	bool operator>(const fraction& other) const
 	{
-		fraction factor(other);
-		return get_float_value() > factor.get_float_value();
+		return (long long) top * other.bottom > (long long) other.top * bottom;
 	}
 
 	fraction& operator+=(const fraction& other)
 	{
-		int other_top = other.top * bottom;
-		top *= other.bottom;
-		top += other_top;
-		bottom *= other.bottom;
-		simplify();
+		*this = add(other, 1);
 		return *this;
 	}
 
 	fraction operator+(const fraction& other) const
 	{
-		int other_top = other.top * bottom;
-		int this_top = top * other.bottom;
-		return fraction(other_top + this_top, bottom * other.bottom);
+		return add(other, 1);
 	}
 
 	fraction& operator-=(const fraction& other)
 	{
-		int other_top = other.top * bottom;
-		top *= other.bottom;
-		top -= other_top;
-		bottom *= other.bottom;
-		simplify();
+		*this = add(other, -1);
 		return *this;
 	}
 
 	fraction operator-(const fraction& other) const
 	{
-		int other_top = other.top * bottom;
-		int this_top = top * other.bottom;
-		return fraction(this_top - other_top, bottom * other.bottom);
+		return add(other, -1);
 	}
 
 	fraction& operator*=(const fraction& other)
 	{
-		top *= other.top;
-		bottom *= other.bottom;
-		simplify();
+		*this = multiply(other.top, other.bottom);
 		return *this;
 	}
 
 	fraction operator*(const fraction& other) const
 	{
-		return fraction(top * other.top, bottom * other.bottom);
+		return multiply(other.top, other.bottom);
 	}
 
 	fraction& operator/=(const fraction& other)
 	{
-		top *= other.bottom;
-		bottom *= other.top;
-		simplify();
+		*this = multiply(other.bottom, other.top);
 		return *this;
 	}
 
 	fraction operator/(const fraction& other) const
 	{
-		return fraction(top * other.bottom, bottom * other.top);
+		return multiply(other.bottom, other.top);
 	}
 
 	// modifier
@@ -154,16 +190,26 @@ public:
 	}
 
 	// access
+	int get_top() const
+	{
+		return top;
+	}
+
+	int get_bottom() const
+	{
+		return bottom;
+	}
+
 	float get_float_value()
 	{
 		if (bottom == 0) return 0;
 		return (float) top / bottom;
 	}
 
-	void print()
+	void print(std::ostream& out = std::cout)
 	{
-		if (bottom != 1) std::cout << top << "/" << bottom;
-		else std::cout << top;
+		if (bottom != 1) out << top << "/" << bottom;
+		else out << top;
 	}
 
 	// special condition
@@ -0,0 +1,134 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <random>
+#include "fraction.h"
+
+using namespace std;
+
+// the fraction kernels before cross-cancellation, kept here to compare against
+class old_fraction
+{
+	int top;
+	int bottom;
+
+	void simplify()
+	{
+		int factor = std::__gcd(top, bottom);
+		if (factor != 0)
+		{
+			top /= factor;
+			bottom /= factor;
+		}
+		if (bottom < 0)
+		{
+			top *= -1;
+			bottom *= -1;
+		}
+	}
+public:
+	old_fraction() : top(0), bottom(1) { }
+	old_fraction(const int t, const int b) : top(t), bottom(b) { simplify(); }
+
+	old_fraction operator+(const old_fraction& other) const { return old_fraction(top * other.bottom + other.top * bottom, bottom * other.bottom); }
+	old_fraction operator-(const old_fraction& other) const { return old_fraction(top * other.bottom - other.top * bottom, bottom * other.bottom); }
+	old_fraction operator*(const old_fraction& other) const { return old_fraction(top * other.top, bottom * other.bottom); }
+	old_fraction operator/(const old_fraction& other) const { return old_fraction(top * other.bottom, bottom * other.top); }
+	bool operator<(const old_fraction& other) const { return (float) top / bottom < (float) other.top / other.bottom; }
+
+	int get_top() const { return top; }
+};
+
+// binary (Stein) gcd, measured against Euclid's algorithm in sic::gcd
+int stein_gcd(int a, int b)
+{
+	unsigned int u = a < 0 ? 0u - (unsigned int) a : (unsigned int) a;
+	unsigned int v = b < 0 ? 0u - (unsigned int) b : (unsigned int) b;
+	if (u == 0) return v;
+	if (v == 0) return u;
+
+	int shift = __builtin_ctz(u | v);
+	u >>= __builtin_ctz(u);
+	while (v != 0)
+	{
+		v >>= __builtin_ctz(v);
+		if (u > v) swap(u, v);
+		v -= u;
+	}
+	return u << shift;
+}
+
+const int total_round = 10000000;
+const int total_operand = 1024; // power of 2, operands are picked by round so nothing is loop invariant
+
+// keep the compiler from dropping the loop
+volatile int sink;
+
+template <typename F>
+void bench(const char* name, F operation)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int round = 0; round < total_round; round++) operation(round & (total_operand - 1), (round * 7 + 3) & (total_operand - 1));
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+	cout << name << "\t" << chrono::duration<double, nano>(stop - start).count() / total_round << " ns/op\n";
+}
+
+// operands like the fraction_test.cpp cases: small ones like 1/3, 2/5 and larger ones like 997/1009
+template <typename T>
+vector<T> make_operand(int limit)
+{
+	mt19937 random(limit);
+	uniform_int_distribution<int> top(-limit, limit), bottom(1, limit);
+	vector<T> operand;
+	for (int pointer = 0; pointer < total_operand; pointer++)
+	{
+		int t = top(random);
+		operand.push_back(T(t == 0 ? 1 : t, bottom(random)));
+	}
+	return operand;
+}
+
+template <typename T>
+void bench_all(const char* label)
+{
+	vector<T> small = make_operand<T>(9);
+	vector<T> large = make_operand<T>(1009);
+
+	cout << label << ":\n";
+	bench("small +", [&](int i, int j) { sink = (small[i] + small[j]).get_top(); });
+	bench("small -", [&](int i, int j) { sink = (small[i] - small[j]).get_top(); });
+	bench("small *", [&](int i, int j) { sink = (small[i] * small[j]).get_top(); });
+	bench("small /", [&](int i, int j) { sink = (small[i] / small[j]).get_top(); });
+	bench("small <", [&](int i, int j) { sink = small[i] < small[j]; });
+	bench("large +", [&](int i, int j) { sink = (large[i] + large[j]).get_top(); });
+	bench("large *", [&](int i, int j) { sink = (large[i] * large[j]).get_top(); });
+	bench("large /", [&](int i, int j) { sink = (large[i] / large[j]).get_top(); });
+	bench("large <", [&](int i, int j) { sink = large[i] < large[j]; });
+}
+
+// gcd of the numerators and denominators simplify sees: products of two small or two large operands
+void bench_gcd()
+{
+	mt19937 random(1);
+	uniform_int_distribution<int> small(-81, 81), large(-1009 * 1009, 1009 * 1009);
+	vector<int> small_value, large_value;
+	for (int pointer = 0; pointer < total_operand; pointer++)
+	{
+		small_value.push_back(small(random));
+		large_value.push_back(large(random));
+	}
+
+	cout << "gcd:\n";
+	bench("Euclid small", [&](int i, int j) { sink = sic::gcd(small_value[i], small_value[j]); });
+	bench("Stein small", [&](int i, int j) { sink = stein_gcd(small_value[i], small_value[j]); });
+	bench("Euclid large", [&](int i, int j) { sink = sic::gcd(large_value[i], large_value[j]); });
+	bench("Stein large", [&](int i, int j) { sink = stein_gcd(large_value[i], large_value[j]); });
+}
+
+int main()
+{
+	bench_gcd();
+	bench_all<old_fraction>("before");
+	bench_all<sic::fraction>("after");
+	return 0;
+}
@@ -26,5 +26,11 @@ int main()
 	f3 = f1 / f2;
 	f3.print();
 	(f1 / f2).print();
+
+	sic::fraction f4(997, 1009);
+	sic::fraction f5(1009, 2991);
+	(f4 * f5).print();
+	(f4 + f5).print();
+	cout << (f1 < f2) << (f1 > f2) << (f4 < f5);
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+//
+// Linear System Solver version 1.1.a
+// Created by Seehait Chockthanyawat
+//
+
+#ifndef SIC_INTEGER_ROW_INCLUDED
+#define SIC_INTEGER_ROW_INCLUDED
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include "fraction.h"
+
+namespace sic
+{
+
+class integer_row
+{
+protected:
+	// the representation of each entry is top[i]/bottom, all entries share one denominator
+	std::vector<long long> top;
+	long long bottom;
+
+	// set when a product or sum did not fit in long long, the row is no longer valid
+	bool overflow;
+
+	// bit size of the largest |top[i]|, kept by every operation so eliminate can bound its products up front
+	size_t top_bit_size;
+
+	// rows with an entry beyond this size are divided by their content to slow down the growth,
+	// this does not bound the entries, every product is still checked for overflow
+	static const long long normalize_limit = 1LL << 30;
+
+	static long long gcd(long long a, long long b)
+	{
+		return sic::gcd(a, b);
+	}
+
+	static long long absolute(long long a)
+	{
+		return a < 0 ? -a : a;
+	}
+
+	// |a| without overflow, LLONG_MIN included
+	static unsigned long long magnitude(long long a)
+	{
+		return a < 0 ? 0 - (unsigned long long) a : a;
+	}
+
+	static size_t bit_length(unsigned long long a)
+	{
+		return a == 0 ? 0 : 64 - __builtin_clzll(a);
+	}
+
+	// the bitwise or of the magnitudes has the bit size of the largest one and needs no branch
+	void update_bit_size()
+	{
+		unsigned long long result = 0;
+		for (size_t pointer = 0; pointer < top.size(); pointer++) result |= magnitude(top[pointer]);
+		top_bit_size = bit_length(result);
+	}
+
+	// divide every entry and the denominator by their common factor
+	void normalize()
+	{
+		long long factor = bottom;
+		for (size_t pointer = 0; pointer < top.size() && factor != 1; pointer++)
+		{
+			factor = gcd(factor, top[pointer]);
+		}
+		if (bottom < 0) factor = -factor;
+		if (factor == 0 || factor == 1) return;
+
+		for (size_t pointer = 0; pointer < top.size(); pointer++)
+		{
+			top[pointer] /= factor;
+		}
+		bottom /= factor;
+		update_bit_size();
+	}
+
+	// normalize only when some entry has grown large, the content gcd is the expensive part
+	void normalize_if_large()
+	{
+		update_bit_size();
+		bool is_large = absolute(bottom) >= normalize_limit || top_bit_size > bit_length(normalize_limit - 1);
+		if (is_large || bottom < 0) normalize();
+	}
+public:
+	// default constructor
+	integer_row() : bottom(1), overflow(false), top_bit_size(0) { }
+
+	// custom constructor, bring every fraction in the row to their least common denominator
+	integer_row(const std::vector<fraction>& row) : top(row.size()), bottom(1), overflow(false), top_bit_size(0)
+	{
+		for (size_t pointer = 0; pointer < row.size() && !overflow; pointer++)
+		{
+			long long other_bottom = row[pointer].get_bottom();
+			if (other_bottom != 0) overflow = __builtin_mul_overflow(bottom / gcd(bottom, other_bottom), other_bottom, &bottom);
+		}
+		for (size_t pointer = 0; pointer < row.size() && !overflow; pointer++)
+		{
+			long long other_bottom = row[pointer].get_bottom();
+			if (other_bottom != 0) overflow = __builtin_mul_overflow((long long) row[pointer].get_top(), bottom / other_bottom, &top[pointer]);
+		}
+		if (!overflow)
+		{
+			update_bit_size();
+			normalize();
+		}
+	}
+
+	// row operation: -k * pivot_row + this, where k makes the entry in target_col zero, false on overflow
+	bool eliminate(const integer_row& pivot_row, size_t target_col)
+	{
+		long long factor = top[target_col];
+		long long pivot = pivot_row.top[target_col];
+		overflow = overflow || pivot_row.overflow;
+		if (overflow) return false;
+		if (factor == 0) return true;
+
+		// both products stay below 2^62 when their bit sizes add up to at most 62, so the difference
+		// fits in long long and is never LLONG_MIN, then the loop needs no check and is vectorized
+		if (top_bit_size + bit_length(magnitude(pivot)) <= 62 && bit_length(magnitude(factor)) + pivot_row.top_bit_size <= 62)
+		{
+			const long long* other = pivot_row.top.data();
+			long long* target = top.data();
+			for (size_t pointer = 0; pointer < top.size(); pointer++)
+			{
+				target[pointer] = target[pointer] * pivot - factor * other[pointer];
+			}
+		}
+		else
+		{
+			// collect the overflow of every entry without an early exit, the row is discarded anyway
+			bool is_overflow = false;
+			for (size_t pointer = 0; pointer < top.size(); pointer++)
+			{
+				long long this_top, other_top;
+				is_overflow |= __builtin_mul_overflow(top[pointer], pivot, &this_top);
+				is_overflow |= __builtin_mul_overflow(factor, pivot_row.top[pointer], &other_top);
+				is_overflow |= __builtin_sub_overflow(this_top, other_top, &top[pointer]);
+				is_overflow |= top[pointer] == LLONG_MIN;
+			}
+			if (is_overflow)
+			{
+				overflow = true;
+				return false;
+			}
+		}
+		if (__builtin_mul_overflow(bottom, pivot, &bottom) || bottom == LLONG_MIN)
+		{
+			overflow = true;
+			return false;
+		}
+		normalize_if_large();
+		return true;
+	}
+
+	// make the entry in target_col equals to 1
+	void make_unit(size_t target_col)
+	{
+		if (overflow || top[target_col] == 0) return;
+		bottom = top[target_col];
+		normalize();
+	}
+
+	// access
+	size_t size() const
+	{
+		return top.size();
+	}
+
+	bool is_overflow() const
+	{
+		return overflow;
+	}
+
+	// bit size of numerator plus denominator of the entry in lowest terms
+	size_t get_bit_size(size_t pointer) const
+	{
+		long long factor = gcd(top[pointer], bottom);
+		if (factor == 0) factor = 1;
+
+		size_t size = 0;
+		for (unsigned long long value = absolute(top[pointer] / factor); value > 0; value >>= 1) size++;
+		for (unsigned long long value = absolute(bottom / factor); value > 0; value >>= 1) size++;
+		return size;
+	}
+
+	// the entry as a fraction, false when it does not fit in int
+	bool get_fraction(size_t pointer, fraction& result) const
+	{
+		long long factor = gcd(top[pointer], bottom);
+		if (factor == 0) factor = 1;
+		long long t = top[pointer] / factor;
+		long long b = bottom / factor;
+		if (overflow || t > INT_MAX || t < INT_MIN || b > INT_MAX || b < INT_MIN) return false;
+		result = fraction((int) t, (int) b);
+		return true;
+	}
+
+	// compare the value of the entry in this row with the one in other, the denominators are positive
+	bool is_less(size_t pointer, const integer_row& other) const
+	{
+		return (__int128) top[pointer] * other.bottom < (__int128) other.top[pointer] * bottom;
+	}
+
+	// special condition
+	bool is_zero(size_t pointer) const
+	{
+		return top[pointer] == 0;
+	}
+};
+
+}
+
+#endif
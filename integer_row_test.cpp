@@ -0,0 +1,64 @@
+#include <iostream>
+#include <vector>
+#include "integer_row.h"
+
+using namespace std;
+
+void print_row(const sic::integer_row& row)
+{
+	for (size_t pointer = 0; pointer < row.size(); pointer++)
+	{
+		sic::fraction entry;
+		if (row.get_fraction(pointer, entry)) entry.print();
+		else cout << "overflow";
+		cout << " ";
+	}
+	cout << endl;
+}
+
+int main()
+{
+	vector<sic::fraction> v1, v2;
+	v1.push_back(sic::fraction(1, 2));
+	v1.push_back(sic::fraction(1, 3));
+	v1.push_back(sic::fraction(1, 1));
+	v2.push_back(sic::fraction(2, 5));
+	v2.push_back(sic::fraction(-3, 4));
+	v2.push_back(sic::fraction(0, 1));
+
+	sic::integer_row r1(v1);
+	sic::integer_row r2(v2);
+	print_row(r1);
+	print_row(r2);
+
+	cout << r2.eliminate(r1, 0) << endl;
+	print_row(r2);
+	r2.make_unit(1);
+	print_row(r2);
+	cout << r1.get_bit_size(1) << r1.is_less(0, r2) << r2.is_zero(0) << endl;
+
+	// 2^31 - 1 squared three times does not fit in long long
+	vector<sic::fraction> v3, v4;
+	v3.push_back(sic::fraction(2147483647, 1));
+	v3.push_back(sic::fraction(1, 2147483646));
+	v4.push_back(sic::fraction(1, 2147483647));
+	v4.push_back(sic::fraction(2147483645, 1));
+
+	sic::integer_row r3(v3);
+	sic::integer_row r4(v4);
+	cout << r4.eliminate(r3, 0) << r4.is_overflow() << endl;
+	print_row(r4);
+
+	// 33 + 31 bits is beyond the bound, the checked loop still finds that 2 * (2^31 - 1)^2 fits
+	vector<sic::fraction> v5, v6;
+	v5.push_back(sic::fraction(2147483647, 1));
+	v5.push_back(sic::fraction(0, 1));
+	v6.push_back(sic::fraction(1, 2));
+	v6.push_back(sic::fraction(2147483647, 1));
+
+	sic::integer_row r5(v5);
+	sic::integer_row r6(v6);
+	cout << r6.eliminate(r5, 0) << r6.is_overflow() << endl;
+	print_row(r6);
+	return 0;
+}
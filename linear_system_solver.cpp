@@ -4,31 +4,115 @@
 //
 
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <string>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <cstdlib>
 #include "fraction.h"
+#include "integer_row.h"
+#include "sparse_solver.h"
+#include "batch_solver.h"
 
-std::vector<std::vector<sic::fraction> > input; // input matrix
-std::vector<sic::fraction> output; // output (particular part)
-size_t total_row, total_col; // total row, column of the input matrix
+thread_local std::vector<std::vector<sic::fraction> > input; // input matrix
+thread_local std::vector<sic::fraction> output; // output (particular part)
+thread_local size_t total_row, total_col; // total row, column of the input matrix
 
-size_t solution_type; // 0 = unique solution, 1 = infinitely many solution, 2 = no solution (contradiction)
+thread_local size_t solution_type; // 0 = unique solution, 1 = infinitely many solution, 2 = no solution (contradiction)
 
 size_t calculation_mode; // 0 = associate homogeneoous system, 1 = particular system
 
-std::vector<std::vector<sic::fraction> > free_var; // free variables (homogeneous part)
-std::vector<size_t> free_var_pos; // index of each free variable
-size_t total_free_var; // total free variable
+size_t pivot_strategy; // 0 = smallest value, 1 = smallest bit size, 2 = Markowitz (fewest fill-in, then smallest bit size)
+const char* pivot_strategy_name[] = { "smallest value", "smallest bit size", "Markowitz" };
+size_t representation_mode; // 0 = fraction for each entry, 1 = integer rows with a common denominator
+const char* representation_name[] = { "fraction entries", "integer rows" };
+thread_local size_t representation_used; // representation that produced the last reduction, integer rows fall back to fractions on overflow
+thread_local size_t total_row_operation; // row operation(s) done by the last reduction
+thread_local size_t max_bit_size; // bit size of the largest entry after the last reduction
+
+thread_local std::vector<std::vector<sic::fraction> > free_var; // free variables (homogeneous part)
+thread_local std::vector<size_t> free_var_pos; // index of each free variable
+thread_local size_t total_free_var; // total free variable
+
+std::vector<std::vector<std::vector<sic::fraction> > > batch_input; // batch of input matrices as entered: batch_input[row][col][system]
+size_t total_batch; // total system in the batch
+
+const size_t dense_fallback_limit = 2000; // largest sparse system that is classified by the dense solver when the sparse solver fails
+
+// a parsed system waiting in the stream queue
+struct linear_system
+{
+	size_t index;
+	size_t total_row, total_col;
+	std::vector<std::vector<sic::fraction> > matrix;
+};
+
+const size_t stream_window = 64; // systems parsed but not yet printed before the reader blocks, bounds the memory of a stream
+std::deque<linear_system> stream_queue; // systems parsed by the reader, waiting for a solver worker
+std::map<size_t, std::string> stream_result; // formatted solutions waiting for the writer, by input index
+size_t total_stream_system; // systems parsed so far
+size_t total_stream_in_flight; // systems parsed but not yet printed
+std::mutex stream_mutex;
+std::condition_variable stream_not_empty, stream_not_full, stream_result_ready;
+bool stream_finished; // the reader has reached the end of the stream
+
+// bit size of an integer
+size_t bit_size(long long target)
+{
+	size_t size = 0;
+	for (unsigned long long value = std::llabs(target); value > 0; value >>= 1) size++;
+	return size;
+}
+
+// bit size of numerator plus denominator, the cost of doing arithmetic with this fraction
+size_t bit_size(const sic::fraction& target)
+{
+	return bit_size(target.get_top()) + bit_size(target.get_bottom());
+}
+
+// cost of choosing an entry as pivot under the selected strategy, smaller is better
+// bits is the bit size of the entry, row_count and col_count the nonzero entries in its row and column
+std::pair<size_t, size_t> strategy_cost(size_t bits, size_t row_count, size_t col_count)
+{
+	if (pivot_strategy != 2) return std::make_pair(bits, (size_t) 0);
+
+	// Markowitz count (r - 1)(c - 1) estimates the fill-in caused by this pivot
+	return std::make_pair((row_count - 1) * (col_count - 1), bits);
+}
+
+// pivot cost of the target entry of the input matrix
+std::pair<size_t, size_t> pivot_cost(size_t start_row_index, size_t target_row, size_t target_col)
+{
+	size_t row_count = 0;
+	for (size_t col_pointer = target_col; col_pointer < total_col; col_pointer++)
+	{
+		if (!input[target_row][col_pointer].is_zero()) row_count++;
+	}
+	size_t col_count = 0;
+	for (size_t row_pointer = start_row_index; row_pointer < total_row; row_pointer++)
+	{
+		if (!input[row_pointer][target_col].is_zero()) col_count++;
+	}
+	return strategy_cost(bit_size(input[target_row][target_col]), row_count, col_count);
+}
 
 // sort the row, prepare the matrix before doing next reduction
 void sort_row(size_t start_row_index, size_t target_col)
 {
 	std::vector<sic::fraction> fraction_table;
+	std::vector<std::pair<size_t, size_t> > cost_table;
 	std::vector<size_t> index_table;
 
 	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
 	{
 		fraction_table.push_back(input[row_pointer][target_col]);
+		if (pivot_strategy != 0 && row_pointer >= start_row_index && !input[row_pointer][target_col].is_zero()) cost_table.push_back(pivot_cost(start_row_index, row_pointer, target_col));
+		else cost_table.push_back(std::make_pair((size_t) 0, (size_t) 0));
 		index_table.push_back(row_pointer);
 	}
 
@@ -38,9 +122,14 @@ void sort_row(size_t start_row_index, size_t target_col)
 		sorted = true;
 		for (size_t row_pointer = start_row_index; row_pointer < total_row - 1; row_pointer++)
 		{
-			if ((!fraction_table[row_pointer + 1].is_zero() && fraction_table[row_pointer + 1] < fraction_table[row_pointer]) || (fraction_table[row_pointer].is_zero() && !fraction_table[row_pointer + 1].is_zero()))
+			bool is_better;
+			if (pivot_strategy == 0) is_better = fraction_table[row_pointer + 1] < fraction_table[row_pointer];
+			else is_better = cost_table[row_pointer + 1] < cost_table[row_pointer];
+
+			if ((!fraction_table[row_pointer + 1].is_zero() && is_better) || (fraction_table[row_pointer].is_zero() && !fraction_table[row_pointer + 1].is_zero()))
 			{
 				std::swap(fraction_table[row_pointer], fraction_table[row_pointer + 1]);
+				std::swap(cost_table[row_pointer], cost_table[row_pointer + 1]);
 				std::swap(index_table[row_pointer], index_table[row_pointer + 1]);
 				sorted = false;
 			}
@@ -59,6 +148,7 @@ void sort_row(size_t start_row_index, size_t target_col)
 void row_operation(size_t init_row, size_t init_col, size_t target_row)
 {
 	sic::fraction factor(input[target_row][init_col] / input[init_row][init_col]);
+	total_row_operation++;
 
 	for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
 	{
@@ -66,17 +156,14 @@ void row_operation(size_t init_row, size_t init_col, size_t target_row)
 	}
 }
 
-// reduction to echelon form
+// reduction to echelon form, the pivot of target column is already sorted into start row
 void reduce_row_forward(size_t target_col, size_t start_row)
 {
-	size_t start_row_index = start_row;
-	if (target_col > 0) while (!input[start_row_index][target_col - 1].is_zero() && start_row_index < total_row - 1) start_row_index++;
-	if (start_row_index == total_row - 1) return;
-	if (input[start_row_index][target_col].is_zero()) return;
+	if (input[start_row][target_col].is_zero()) return;
 
-	for (size_t row_pointer = start_row_index + 1; row_pointer < total_row; row_pointer++)
+	for (size_t row_pointer = start_row + 1; row_pointer < total_row; row_pointer++)
 	{
-		row_operation(start_row_index, target_col, row_pointer);
+		row_operation(start_row, target_col, row_pointer);
 	}
 }
 
@@ -126,17 +213,112 @@ bool is_non_zero_row(size_t target_row)
 	return false;
 }
 
+// find the largest entry of the reduced matrix
+void calculate_max_bit_size()
+{
+	max_bit_size = 0;
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+		{
+			max_bit_size = std::max(max_bit_size, bit_size(input[row_pointer][col_pointer]));
+		}
+	}
+}
+
+// make reduced echelon form matrix with integer rows, fractions are only restored at the end
+// returns false and leaves the input untouched when an entry overflows
+bool make_reduced_echelon_form_integer()
+{
+	size_t limit = total_col;
+
+	std::vector<sic::integer_row> rows;
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		rows.push_back(sic::integer_row(input[row_pointer]));
+		if (rows.back().is_overflow()) return false;
+	}
+
+	total_row_operation = 0;
+	size_t row_pointer = 0;
+	for (size_t col_pointer = 0; col_pointer < limit && row_pointer < total_row; col_pointer++)
+	{
+		// the same choice as sort_row makes for the fraction engine
+		size_t col_count = 0;
+		for (size_t candidate_row = row_pointer; candidate_row < total_row; candidate_row++)
+		{
+			if (!rows[candidate_row].is_zero(col_pointer)) col_count++;
+		}
+
+		size_t pivot_row = total_row;
+		std::pair<size_t, size_t> best_cost;
+		for (size_t candidate_row = row_pointer; candidate_row < total_row; candidate_row++)
+		{
+			if (rows[candidate_row].is_zero(col_pointer)) continue;
+
+			size_t row_count = 0;
+			for (size_t target_col = col_pointer; target_col < total_col; target_col++)
+			{
+				if (!rows[candidate_row].is_zero(target_col)) row_count++;
+			}
+			std::pair<size_t, size_t> candidate_cost = strategy_cost(rows[candidate_row].get_bit_size(col_pointer), row_count, col_count);
+
+			bool is_better;
+			if (pivot_row == total_row) is_better = true;
+			else if (pivot_strategy == 0) is_better = rows[candidate_row].is_less(col_pointer, rows[pivot_row]);
+			else is_better = candidate_cost < best_cost;
+
+			if (is_better)
+			{
+				pivot_row = candidate_row;
+				best_cost = candidate_cost;
+			}
+		}
+		if (pivot_row == total_row) continue;
+
+		std::swap(rows[pivot_row], rows[row_pointer]);
+		rows[row_pointer].make_unit(col_pointer);
+		for (size_t target_row = 0; target_row < total_row; target_row++)
+		{
+			if (target_row == row_pointer || rows[target_row].is_zero(col_pointer)) continue;
+			if (!rows[target_row].eliminate(rows[row_pointer], col_pointer)) return false;
+			total_row_operation++;
+		}
+		row_pointer++;
+	}
+
+	std::vector<std::vector<sic::fraction> > result(total_row, std::vector<sic::fraction>(total_col));
+	for (row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+		{
+			if (!rows[row_pointer].get_fraction(col_pointer, result[row_pointer][col_pointer])) return false;
+		}
+	}
+	input.swap(result);
+	calculate_max_bit_size();
+	return true;
+}
+
 // make reduced echelon form matrix
 void make_reduced_echelon_form()
 {
-	size_t limit;
-	if (calculation_mode == 0) limit = std::min(total_row, total_col);
-	else if (calculation_mode == 1) limit = std::min(total_row, total_col - 1);
+	representation_used = representation_mode;
+	if (representation_mode == 1)
+	{
+		if (make_reduced_echelon_form_integer()) return;
+		representation_used = 0;
+	}
+
+	// every column gets a forward step as long as there is a row left for its pivot,
+	// the right-hand side is reduced too, so the result is the unique reduced echelon form of the whole matrix
+	size_t limit = total_col;
 
+	total_row_operation = 0;
 	size_t row_pointer = 0;
-	for (size_t col_pointer = 0; col_pointer < limit; col_pointer++)
+	for (size_t col_pointer = 0; col_pointer < limit && row_pointer < total_row; col_pointer++)
 	{
-		if (is_non_zero_col(0, col_pointer))
+		if (is_non_zero_col(row_pointer, col_pointer))
 		{
 			sort_row(row_pointer, col_pointer);
 			reduce_row_forward(col_pointer, row_pointer);
@@ -144,13 +326,13 @@ void make_reduced_echelon_form()
 		}
 	}
 
-	for (size_t col_pointer = total_col - 1; col_pointer > 0; col_pointer--)
+	for (size_t col_pointer = limit; col_pointer > 0; col_pointer--)
 	{
 		if (is_non_zero_col(0, col_pointer - 1)) reduce_row_backward(col_pointer - 1);
 	}
 
 	row_pointer = 0;
-	for (size_t col_pointer = 0; col_pointer < total_col - 1; col_pointer++)
+	for (size_t col_pointer = 0; col_pointer < limit; col_pointer++)
 	{
 		if (is_non_zero_col(row_pointer, col_pointer))
 		{
@@ -158,24 +340,26 @@ void make_reduced_echelon_form()
 			row_pointer++;
 		}
 	}
+
+	calculate_max_bit_size();
 }
 
-// calculate the output (particular part)
-void calculate_output()
+// column of the leading entry of the target row of the reduced matrix, total_col - 1 when it has no variable
+size_t find_pivot_col(size_t target_row)
 {
-	size_t row_pointer = 0;
 	size_t col_pointer = 0;
-	size_t limit = std::min(total_row, total_col - 1);
-	output.resize(total_col - 1);
+	while (col_pointer < total_col - 1 && input[target_row][col_pointer].is_zero()) col_pointer++;
+	return col_pointer;
+}
 
-	while (row_pointer < limit && col_pointer < total_col - 1)
+// calculate the output (particular part)
+void calculate_output()
+{
+	output.assign(total_col - 1, sic::fraction());
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
 	{
-		if (is_non_zero_col(row_pointer, col_pointer))
-		{
-			if (!input[row_pointer][col_pointer].is_zero()) output[col_pointer] = input[row_pointer][total_col - 1] / input[row_pointer][col_pointer];
-			row_pointer++;
-		}
-		col_pointer++;
+		size_t col_pointer = find_pivot_col(row_pointer);
+		if (col_pointer < total_col - 1) output[col_pointer] = input[row_pointer][total_col - 1] / input[row_pointer][col_pointer];
 	}
 }
 
@@ -184,61 +368,48 @@ void check_solution_type()
 {
 	solution_type = 0;
 	if (total_free_var > 0) solution_type = 1;
-	for (size_t pointer = total_col - 1 - total_free_var; pointer < total_row; pointer++)
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
 	{
-		if (!input[pointer][total_col - 1].is_zero()) solution_type = 2;
+		if (!is_non_zero_row(row_pointer) && !input[row_pointer][total_col - 1].is_zero()) solution_type = 2;
 	}
 }
 
-// calculate homogeneous part
+// calculate homogeneous part, free_var[i] is the coefficient of each free variable in variable i
 void calculate_free_var()
 {
-	total_free_var = 0;
-	free_var_pos.clear();
-
+	std::vector<size_t> pivot_row(total_col - 1, total_row);
 	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
 	{
-		if (!is_non_zero_row(row_pointer)) total_free_var++;
+		size_t col_pointer = find_pivot_col(row_pointer);
+		if (col_pointer < total_col - 1) pivot_row[col_pointer] = row_pointer;
 	}
 
-	total_free_var += total_col - total_row - 1;
-
-	size_t col_pointer = 0;
-	while (col_pointer < total_col - 1)
-	{
-		if (!is_non_zero_col(free_var_pos.size(), col_pointer)) free_var_pos.push_back(col_pointer);
-		col_pointer++;
-	}
-
-	col_pointer = total_col - total_free_var + free_var_pos.size() - 1;
-	while (free_var_pos.size() < total_free_var)
+	free_var_pos.clear();
+	for (size_t col_pointer = 0; col_pointer < total_col - 1; col_pointer++)
 	{
-		free_var_pos.push_back(col_pointer);
-		col_pointer++;
+		if (pivot_row[col_pointer] == total_row) free_var_pos.push_back(col_pointer);
 	}
+	total_free_var = free_var_pos.size();
 
-	free_var.resize(output.size());
-	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	free_var.assign(total_col - 1, std::vector<sic::fraction>(total_free_var));
+	for (size_t col_pointer = 0; col_pointer < total_col - 1; col_pointer++)
 	{
-		free_var[row_pointer].resize(total_free_var);
-	}
+		if (pivot_row[col_pointer] == total_row) continue;
 
-	for (size_t free_var_pointer = 0; free_var_pointer < total_free_var; free_var_pointer++)
-	{
-		for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+		const std::vector<sic::fraction>& row = input[pivot_row[col_pointer]];
+		for (size_t free_var_pointer = 0; free_var_pointer < total_free_var; free_var_pointer++)
 		{
-			free_var[row_pointer][free_var_pointer] = sic::fraction(-1, 1) * input[row_pointer][free_var_pos[free_var_pointer]];
+			free_var[col_pointer][free_var_pointer] = sic::fraction(-1, 1) * row[free_var_pos[free_var_pointer]] / row[col_pointer];
 		}
 	}
 }
 
-// check all free variables in the target row is zero or not
-bool is_all_free_var_zero(size_t target_row)
+// check all free variables in the target variable is zero or not
+bool is_all_free_var_zero(size_t target_var)
 {
-	if (target_row >= total_row) return true;
 	for (size_t free_var_pointer = 0; free_var_pointer < total_free_var; free_var_pointer++)
 	{
-		if (!free_var[target_row][free_var_pointer].is_zero()) return false;
+		if (!free_var[target_var][free_var_pointer].is_zero()) return false;
 	}
 	return true;
 }
@@ -276,16 +447,16 @@ void print_input()
 }
 
 // print the solution
-void print_output()
+void print_output(std::ostream& out = std::cout)
 {
-	std::cout << "The solution is: \n\n";
+	out << "The solution is: \n\n";
 	if (solution_type == 0)
 	{
 		for (size_t col_pointer = 0; col_pointer < total_col - 1; col_pointer++)
 		{
-			std::cout << "c" << col_pointer << " = ";
-			output[col_pointer].print();
-			std::cout << std::endl;
+			out << "c" << col_pointer << " = ";
+			output[col_pointer].print(out);
+			out << std::endl;
 		}
 	}
 	else if (solution_type == 1)
@@ -303,52 +474,52 @@ void print_output()
 				{
 					if (output[output_pointer].is_zero() && is_all_free_var_zero(output_pointer))
 					{
-						std::cout << "c" << col_pointer << " = " << 0 << std::endl;
+						out << "c" << col_pointer << " = " << 0 << std::endl;
 					}
 					else
 					{
-						std::cout << "c" << col_pointer << " = ";
+						out << "c" << col_pointer << " = ";
 						if (!output[output_pointer].is_zero())
 						{
-							output[output_pointer].print();
-							for (size_t free_var_pointer = 0; free_var_pointer < total_free_var && output_pointer < total_row; free_var_pointer++)
+							output[output_pointer].print(out);
+							for (size_t free_var_pointer = 0; free_var_pointer < total_free_var; free_var_pointer++)
 							{
 								if (!free_var[output_pointer][free_var_pointer].is_zero()) 
 								{
-									std::cout << " + (";
-									free_var[output_pointer][free_var_pointer].print();
-									std::cout << ")c" << free_var_pos[free_var_pointer];
+									out << " + (";
+									free_var[output_pointer][free_var_pointer].print(out);
+									out << ")c" << free_var_pos[free_var_pointer];
 								}
 							}
-							std::cout << std::endl;
+							out << std::endl;
 						}
 						else
 						{
 							size_t free_var_pointer = 0;
 							while (free_var[output_pointer][free_var_pointer].is_zero()) free_var_pointer++;
-							std::cout << "(";
-							free_var[output_pointer][free_var_pointer].print();
-							std::cout << ")c" << free_var_pos[free_var_pointer];
+							out << "(";
+							free_var[output_pointer][free_var_pointer].print(out);
+							out << ")c" << free_var_pos[free_var_pointer];
 							
 							free_var_pointer++;
 							while (free_var_pointer < total_free_var)
 							{
 								if (!free_var[output_pointer][free_var_pointer].is_zero())
 								{
-									std::cout << " + (";
-									free_var[output_pointer][free_var_pointer].print();
-									std::cout << ")c" << free_var_pos[free_var_pointer];
+									out << " + (";
+									free_var[output_pointer][free_var_pointer].print(out);
+									out << ")c" << free_var_pos[free_var_pointer];
 								}
 								free_var_pointer++;
 							}
-							std::cout << std::endl;
+							out << std::endl;
 						}
 					}
 				}
 			}
 			else
 			{
-				std::cout << "c" << col_pointer << " = any real number\n";
+				out << "c" << col_pointer << " = any real number\n";
 				free_var_cnt++;
 			}
 			output_pointer++;
@@ -356,10 +527,51 @@ void print_output()
 	}
 	else if (solution_type == 2)
 	{
-		std::cout << "Error:\tThere is at least one constadiction in this system,\n\tthus this system has no solution.\n";
+		out << "Error:\tThere is at least one constadiction in this system,\n\tthus this system has no solution.\n";
 	}
 }
 
+// load the target system of the batch into the solver and classify it
+void load_batch_system(const sic::batch_solver& solver, size_t target_batch)
+{
+	size_t total_var = total_col - 1;
+	output.resize(total_var);
+
+	if (solver.is_solved(target_batch))
+	{
+		for (size_t row_pointer = 0; row_pointer < total_var; row_pointer++)
+		{
+			output[row_pointer] = solver.get_solution(target_batch, row_pointer);
+		}
+		total_free_var = 0;
+		solution_type = 0;
+		return;
+	}
+
+	// the batch solver gave up on this system, so classify the original system like -p does
+	input.resize(total_row);
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		input[row_pointer].resize(total_col);
+		for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+		{
+			input[row_pointer][col_pointer] = batch_input[row_pointer][col_pointer][target_batch];
+		}
+	}
+	make_reduced_echelon_form();
+	calculate_output();
+	calculate_free_var();
+	check_solution_type();
+}
+
+// print the statistics of the last reduction
+void print_stats()
+{
+	std::cout << "Representation: " << representation_name[representation_used];
+	if (representation_used != representation_mode) std::cout << " (integer rows overflowed)";
+	std::cout << ", pivot strategy: " << pivot_strategy_name[pivot_strategy] << ", row operation(s): " << total_row_operation << ", largest entry: " << max_bit_size << " bit(s)\n";
+}
+
 // set title bar of the console
 void set_title() {
     char esc_start[] = { 0x1b, ']', '0', ';', 0 };
@@ -383,7 +595,7 @@ void print_instruction()
 	std::cout << "                       Linear System Solver version 1.1.a                       ";
 	std::cout << "                            by Seehait Chockthanyawat                           ";
 	std::cout << std::endl << "--------------------------------------------------------------------------------\n";
-	std::cout << "Please enter: \t-h for solve associate homogeneous system\n\t\t-p for solve particular system\n\t\t-e for calculate reduced echelon form matrix\n\t\t-x or other to exit\n";
+	std::cout << "Please enter: \t-h for solve associate homogeneous system\n\t\t-p for solve particular system\n\t\t-e for calculate reduced echelon form matrix\n\t\t-b for solve a batch of particular systems\n\t\t-s for solve a stream of particular systems\n\t\t-w for solve a large sparse system\n\t\t-o for change solver options\n\t\t-x or other to exit\n";
 }
 
 // print the exit instruction
@@ -520,6 +732,152 @@ void get_matrix_input()
 	}
 }
 
+// get a batch of particular systems with the same size from the user
+void get_batch_system_input()
+{
+	clear_screen();
+	std::cout << "Number of variable(s) and equation(s) of each system: ";
+	std::cin >> total_row;
+	total_col = total_row + 1;
+
+	std::cout << "Number of system(s): ";
+	std::cin >> total_batch;
+
+	clear_screen();
+	batch_input.resize(total_row);
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		batch_input[row_pointer].resize(total_col);
+		for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+		{
+			batch_input[row_pointer][col_pointer].resize(total_batch);
+		}
+	}
+
+	std::cout << "Please enter each augmented matrix one after another (represent each element in integer or fraction form)\n\n";
+	std::cout << "For example, the systems are\t x + y = 3\t and\t 2x - y = 0\n\t\t\t\t x - y = 1\t\t x + y = 3\n";
+	std::cout << "--------------------------------------------------------------------------------\n";
+	std::cout << "You can enter input like this:\t1 1 3\n\t\t\t\t1 -1 1\n\t\t\t\t2 -1 0\n\t\t\t\t1 1 3\n";
+	std::cout << "--------------------------------------------------------------------------------\n";
+	std::cout << "Or you can enter input like this: 1 1 3 1 -1 1 2 -1 0 1 1 3\n";
+	std::cout << "--------------------------------------------------------------------------------\n";
+	std::cout << "Input: ";
+	for (size_t batch_pointer = 0; batch_pointer < total_batch; batch_pointer++)
+	{
+		for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+		{
+			for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+			{
+				batch_input[row_pointer][col_pointer][batch_pointer] = get_fraction();
+			}
+		}
+	}
+}
+
+// read particular systems until 0 variable(s) or end of input, runs on its own thread
+void read_stream_input()
+{
+	while (true)
+	{
+		linear_system system;
+		if (!(std::cin >> system.total_col) || system.total_col == 0) break;
+		system.total_col++;
+		if (!(std::cin >> system.total_row)) break;
+
+		system.matrix.resize(system.total_row);
+		for (size_t row_pointer = 0; row_pointer < system.total_row; row_pointer++)
+		{
+			system.matrix[row_pointer].resize(system.total_col);
+			for (size_t col_pointer = 0; col_pointer < system.total_col; col_pointer++)
+			{
+				system.matrix[row_pointer][col_pointer] = get_fraction();
+			}
+		}
+
+		std::unique_lock<std::mutex> lock(stream_mutex);
+		stream_not_full.wait(lock, [] { return total_stream_in_flight < stream_window; });
+		system.index = total_stream_system++;
+		total_stream_in_flight++;
+		stream_queue.push_back(std::move(system));
+		stream_not_empty.notify_one();
+	}
+
+	std::lock_guard<std::mutex> lock(stream_mutex);
+	stream_finished = true;
+	stream_not_empty.notify_all();
+	stream_result_ready.notify_all();
+}
+
+// solve systems from the stream queue, the solver state is thread local so workers run side by side
+void solve_stream_input()
+{
+	while (true)
+	{
+		linear_system system;
+		{
+			std::unique_lock<std::mutex> lock(stream_mutex);
+			stream_not_empty.wait(lock, [] { return !stream_queue.empty() || stream_finished; });
+			if (stream_queue.empty()) return;
+			system = std::move(stream_queue.front());
+			stream_queue.pop_front();
+		}
+
+		total_row = system.total_row;
+		total_col = system.total_col;
+		input.swap(system.matrix);
+		make_reduced_echelon_form();
+		calculate_output();
+		calculate_free_var();
+		check_solution_type();
+
+		std::ostringstream text;
+		text << "\n--------------------------------------------------------------------------------\n";
+		text << "System " << system.index + 1 << ":\n";
+		print_output(text);
+
+		std::lock_guard<std::mutex> lock(stream_mutex);
+		stream_result[system.index] = text.str();
+		stream_result_ready.notify_one();
+	}
+}
+
+// get a large sparse particular system from the user, only nonzero entries are entered,
+// return the number of coefficient(s) outside the system, they are ignored
+size_t get_sparse_system_input(sic::sparse_solver& solver)
+{
+	clear_screen();
+	std::cout << "Number of variable(s) and equation(s): ";
+	std::cin >> total_row;
+	total_col = total_row + 1;
+
+	size_t total_entry;
+	std::cout << "Number of nonzero coefficient(s): ";
+	std::cin >> total_entry;
+
+	clear_screen();
+	solver.resize(total_row);
+
+	std::cout << "Please enter each nonzero coefficient as equation, variable and value (count from 0),\nthen the right-hand side of every equation\n\n";
+	std::cout << "For example, the equations is\t 4x + 5/2z = 7\n\t\t\t\t -3y = 0\n\t\t\t\t 6z = 1\n\n";
+	std::cout << "You can enter input like this:\t0 0 4\n\t\t\t\t0 2 5/2\n\t\t\t\t1 1 -3\n\t\t\t\t2 2 6\n\t\t\t\t7 0 1\n";
+	std::cout << "--------------------------------------------------------------------------------\n";
+	std::cout << "Input: ";
+	size_t total_ignored_entry = 0;
+	for (size_t entry_pointer = 0; entry_pointer < total_entry; entry_pointer++)
+	{
+		size_t row_pointer, col_pointer;
+		std::cin >> row_pointer >> col_pointer;
+		sic::fraction entry = get_fraction();
+		if (row_pointer < total_row && col_pointer < total_row) solver.add_entry(row_pointer, col_pointer, entry);
+		else total_ignored_entry++;
+	}
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		solver.set_rhs(row_pointer, get_fraction());
+	}
+	return total_ignored_entry;
+}
+
 // solve the linear system
 void make_solution()
 {
@@ -532,6 +890,8 @@ void make_solution()
 	print_input();
 	std::cout << "\n--------------------------------------------------------------------------------\n";
 	print_output();
+	std::cout << "\n--------------------------------------------------------------------------------\n";
+	print_stats();
 }
 
 // reduce the linear system
@@ -541,6 +901,120 @@ void make_reduced_echelon_form_matrix()
 	make_reduced_echelon_form();
 	std::cout << "The reduced echelon form matrix is:\n\n";
 	print_input();
+	std::cout << "\n--------------------------------------------------------------------------------\n";
+	print_stats();
+}
+
+// get solver options from the user
+void get_solver_options()
+{
+	clear_screen();
+	std::cout << "Pivot strategy (0 = smallest value, 1 = smallest bit size, 2 = Markowitz): ";
+	std::cin >> pivot_strategy;
+	if (pivot_strategy > 2) pivot_strategy = 0;
+	std::cout << "Representation (0 = fraction entries, 1 = integer rows with common denominator): ";
+	std::cin >> representation_mode;
+	if (representation_mode > 1) representation_mode = 0;
+	std::cout << "Pivot strategy is set to " << pivot_strategy_name[pivot_strategy] << ", representation is set to " << representation_name[representation_mode] << ".\n";
+}
+
+// solve a batch of linear systems
+void make_batch_solution()
+{
+	clear_screen();
+	sic::batch_solver solver;
+	solver.resize(total_row, total_batch);
+	for (size_t batch_pointer = 0; batch_pointer < total_batch; batch_pointer++)
+	{
+		for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+		{
+			for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+			{
+				solver.set_entry(batch_pointer, row_pointer, col_pointer, batch_input[row_pointer][col_pointer][batch_pointer]);
+			}
+		}
+	}
+	solver.solve();
+
+	for (size_t batch_pointer = 0; batch_pointer < total_batch; batch_pointer++)
+	{
+		load_batch_system(solver, batch_pointer);
+		if (batch_pointer > 0) std::cout << "\n--------------------------------------------------------------------------------\n";
+		std::cout << "System " << batch_pointer + 1 << ":\n";
+		print_output();
+	}
+}
+
+// solve a stream of linear systems, parsing, solving and printing run on separate threads
+void make_stream_solution()
+{
+	clear_screen();
+	std::cout << "Please enter each system as number of variable(s), number of equation(s) and its augmented matrix\n\n";
+	std::cout << "For example, the equations is\t 4x + 5y + 6z = 7\n\t\t\t\t 8x -3y = 0\n\n";
+	std::cout << "You can enter input like this:\t3 2 4 5/2 6 7 8 -3 0 0\n";
+	std::cout << "--------------------------------------------------------------------------------\n";
+	std::cout << "Enter 0 as number of variable(s) to stop.\n";
+	std::cout << "--------------------------------------------------------------------------------\n";
+	std::cout << "Input: ";
+
+	stream_queue.clear();
+	stream_result.clear();
+	total_stream_system = 0;
+	total_stream_in_flight = 0;
+	stream_finished = false;
+
+	std::thread reader(read_stream_input);
+	std::vector<std::thread> solver;
+	size_t total_solver = std::max(1u, std::thread::hardware_concurrency());
+	for (size_t solver_pointer = 0; solver_pointer < total_solver; solver_pointer++) solver.push_back(std::thread(solve_stream_input));
+
+	// write the solutions in input order while later systems are still being parsed and solved
+	for (size_t system_pointer = 0; ; system_pointer++)
+	{
+		std::string text;
+		{
+			std::unique_lock<std::mutex> lock(stream_mutex);
+			stream_result_ready.wait(lock, [system_pointer] { return stream_result.count(system_pointer) > 0 || (stream_finished && system_pointer == total_stream_system); });
+			if (stream_result.count(system_pointer) == 0) break;
+			text.swap(stream_result[system_pointer]);
+			stream_result.erase(system_pointer);
+			total_stream_in_flight--;
+			stream_not_full.notify_one();
+		}
+		std::cout << text;
+	}
+
+	reader.join();
+	for (size_t solver_pointer = 0; solver_pointer < total_solver; solver_pointer++) solver[solver_pointer].join();
+}
+
+// solve a large sparse system iteratively, the dense solver classifies it when there is no unique solution
+void make_sparse_solution(sic::sparse_solver& solver, size_t total_ignored_entry)
+{
+	clear_screen();
+	if (total_ignored_entry > 0)
+	{
+		std::cout << "Error:\t" << total_ignored_entry << " coefficient(s) are outside this system, they are ignored.\n\n";
+	}
+	if (solver.solve(output))
+	{
+		total_free_var = 0;
+		solution_type = 0;
+		print_output();
+	}
+	else if (total_row <= dense_fallback_limit)
+	{
+		solver.get_dense(input);
+		make_reduced_echelon_form();
+		calculate_output();
+		calculate_free_var();
+		check_solution_type();
+		print_output();
+	}
+	else
+	{
+		std::cout << "Error:\tThis system has no unique solution, or its solution is too large to be\n\trepresented, and it is too large to be classified.\n";
+	}
 }
 
 // get selected calculation mode from the user
@@ -569,6 +1043,28 @@ void get_calculation_mode_from_user()
 		get_matrix_input();
 		make_reduced_echelon_form_matrix();		
 	}
+	else if (instruction == "-b")
+	{
+		calculation_mode = 1;
+		get_batch_system_input();
+		make_batch_solution();
+	}
+	else if (instruction == "-s")
+	{
+		calculation_mode = 1;
+		make_stream_solution();
+	}
+	else if (instruction == "-w")
+	{
+		calculation_mode = 1;
+		sic::sparse_solver solver;
+		size_t total_ignored_entry = get_sparse_system_input(solver);
+		make_sparse_solution(solver, total_ignored_entry);
+	}
+	else if (instruction == "-o")
+	{
+		get_solver_options();
+	}
 	else exit(0);
 }
 
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <vector>
+
+// the solver is a single translation unit with its own main
+#define main linear_system_solver_main
+#include "linear_system_solver.cpp"
+#undef main
+
+using namespace std;
+
+// load a particular system given as integers and print its solution
+void solve(size_t total_var, size_t total_equation, const int* matrix)
+{
+	total_col = total_var + 1;
+	total_row = total_equation;
+	input.assign(total_row, vector<sic::fraction>(total_col));
+	for (size_t row_pointer = 0; row_pointer < total_row; row_pointer++)
+	{
+		for (size_t col_pointer = 0; col_pointer < total_col; col_pointer++)
+		{
+			input[row_pointer][col_pointer] = sic::fraction(matrix[row_pointer * total_col + col_pointer], 1);
+		}
+	}
+	make_reduced_echelon_form();
+	calculate_output();
+	calculate_free_var();
+	check_solution_type();
+	print_output();
+}
+
+int main()
+{
+	calculation_mode = 1;
+
+	// c2 = 0, c3 = 5/2 under every pivot strategy, picking 3 as the pivot used to skip the forward step of c3
+	int pivot_case[] = { 0, 0, 5, -2, -5, 0, 0, 3, 0, 0, 0, 0, -5, 2, 5 };
+	for (pivot_strategy = 0; pivot_strategy < 3; pivot_strategy++)
+	{
+		solve(4, 3, pivot_case);
+	}
+	pivot_strategy = 0;
+
+	// c0 = (-1)c1 + (3/2)c3 and c2 = 0 in both representations, the solution is read through the pivot columns
+	int representation_case[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 0, -3, 0, 0, 0, -2, 0, 0 };
+
+	// more equations than unknowns, c0 = 0 and c1 = any
+	int overdetermined_case[] = { -2, 0, 0, 5, 0, 0, -5, 0, 0 };
+
+	// no solution, the last row reduces to 0 = 1
+	int inconsistent_case[] = { 1, 1, 2, 2, 2, 3 };
+	for (representation_mode = 0; representation_mode < 2; representation_mode++)
+	{
+		solve(4, 4, representation_case);
+		solve(2, 3, overdetermined_case);
+		solve(2, 2, inconsistent_case);
+	}
+	representation_mode = 0;
+	return 0;
+}
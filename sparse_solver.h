@@ -0,0 +1,415 @@
+//
+// Linear System Solver version 1.1.a
+// Created by Seehait Chockthanyawat
+//
+
+#ifndef SIC_SPARSE_SOLVER_INCLUDED
+#define SIC_SPARSE_SOLVER_INCLUDED
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <climits>
+#include "fraction.h"
+
+namespace sic
+{
+
+typedef unsigned long long number;
+
+// the field Z/prime for a prime of the form 2^shift - offset, a product is reduced by shifts and multiplications instead of a division
+class prime_field
+{
+protected:
+	number prime;
+	int shift;
+	number offset;
+public:
+	// custom constructor
+	prime_field(const int s, const number o) : prime((1ULL << s) - o), shift(s), offset(o) { }
+
+	// arithmetic, every operand is already in [0, prime)
+	number reduce(unsigned __int128 target) const
+	{
+		const number mask = (1ULL << shift) - 1;
+		target = (target >> shift) * offset + (target & mask);
+		target = (target >> shift) * offset + (target & mask);
+		number result = (number) target;
+		while (result >= prime) result -= prime;
+		return result;
+	}
+
+	// unreduced products below prime^2 that can be summed in 128 bits before one reduce
+	size_t lazy_limit() const
+	{
+		return ((size_t) 1 << (128 - 2 * shift)) - 1;
+	}
+
+	number mul(const number a, const number b) const
+	{
+		return reduce((unsigned __int128) a * b);
+	}
+
+	number add(const number a, const number b) const
+	{
+		number result = a + b;
+		return result >= prime ? result - prime : result;
+	}
+
+	number sub(const number a, const number b) const
+	{
+		return a >= b ? a - b : a + prime - b;
+	}
+
+	number power(number base, number exponent) const
+	{
+		number result = 1;
+		while (exponent > 0)
+		{
+			if (exponent & 1) result = mul(result, base);
+			base = mul(base, base);
+			exponent >>= 1;
+		}
+		return result;
+	}
+
+	number inverse(const number a) const
+	{
+		return power(a, prime - 2);
+	}
+
+	// residue of a fraction, every prime is above INT_MAX so a denominator never vanishes
+	number residue(const fraction& target) const
+	{
+		if (target.get_bottom() == 0) return 0;
+		long long top = target.get_top() % (long long) prime;
+		if (top < 0) top += prime;
+		return mul((number) top, inverse((number) target.get_bottom()));
+	}
+
+	// access
+	number get_prime() const
+	{
+		return prime;
+	}
+};
+
+class sparse_solver
+{
+protected:
+	// the solution is found modulo two primes and combined by CRT, their product is above 2 * INT_MAX^2
+	// so every solution with int numerators and denominators can be reconstructed,
+	// the result is checked again modulo a third prime
+	static const prime_field& first_field()
+	{
+		static const prime_field field(61, 1);
+		return field;
+	}
+
+	static const prime_field& second_field()
+	{
+		static const prime_field field(62, 57);
+		return field;
+	}
+
+	static const prime_field& check_field()
+	{
+		static const prime_field field(60, 93);
+		return field;
+	}
+
+	// try this many random preconditioners before the matrix is treated as singular
+	static const size_t total_attempt = 3;
+
+	// nonzeros each thread of a product needs before starting it pays off
+	static const size_t parallel_grain = 1 << 16;
+
+	// threads a product may use, the two primes are solved at the same time so each gets half of the cores
+	size_t total_thread;
+
+	// the matrix in compressed row form, only nonzero entries are stored
+	size_t total_var;
+	std::vector<size_t> row_start;
+	std::vector<size_t> col_index;
+	std::vector<fraction> value;
+	std::vector<fraction> rhs;
+
+	// entries in input order, compressed by compress()
+	std::vector<size_t> entry_row;
+
+	// sort the entries by row, done once before the first product
+	void compress()
+	{
+		if (entry_row.empty()) return;
+
+		std::vector<size_t> order(entry_row.size());
+		for (size_t pointer = 0; pointer < order.size(); pointer++) order[pointer] = pointer;
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return entry_row[a] < entry_row[b]; });
+
+		std::vector<size_t> sorted_col(order.size());
+		std::vector<fraction> sorted_value(order.size());
+		row_start.assign(total_var + 1, 0);
+		for (size_t pointer = 0; pointer < order.size(); pointer++)
+		{
+			sorted_col[pointer] = col_index[order[pointer]];
+			sorted_value[pointer] = value[order[pointer]];
+			row_start[entry_row[order[pointer]] + 1]++;
+		}
+		for (size_t row_pointer = 0; row_pointer < total_var; row_pointer++) row_start[row_pointer + 1] += row_start[row_pointer];
+
+		col_index.swap(sorted_col);
+		value.swap(sorted_value);
+		entry_row.clear();
+	}
+
+	// rows [begin, end) of the product y = A x
+	void multiply_rows(const prime_field& field, const std::vector<number>& matrix, const std::vector<number>& x, std::vector<number>& y, size_t begin, size_t end) const
+	{
+		size_t limit = field.lazy_limit();
+		for (size_t row_pointer = begin; row_pointer < end; row_pointer++)
+		{
+			// products are summed unreduced, the sum is reduced once every limit - 1 terms
+			unsigned __int128 sum = 0;
+			for (size_t start = row_start[row_pointer]; start < row_start[row_pointer + 1]; start += limit - 1)
+			{
+				size_t stop = std::min(row_start[row_pointer + 1], start + limit - 1);
+				for (size_t pointer = start; pointer < stop; pointer++) sum += (unsigned __int128) matrix[pointer] * x[col_index[pointer]];
+				sum = field.reduce(sum);
+			}
+			y[row_pointer] = (number) sum;
+		}
+	}
+
+	// matrix-vector product y = A x, the only access to the matrix the solver needs
+	// the rows are split across threads into parts with about the same number of nonzeros
+	void multiply(const prime_field& field, const std::vector<number>& matrix, const std::vector<number>& x, std::vector<number>& y) const
+	{
+		size_t total_part = std::min(total_thread, value.size() / parallel_grain + 1);
+		std::vector<std::thread> worker;
+		size_t begin = 0;
+		for (size_t part = 1; part < total_part; part++)
+		{
+			size_t end = std::upper_bound(row_start.begin(), row_start.end(), value.size() * part / total_part) - row_start.begin() - 1;
+			end = std::max(begin, end);
+			worker.push_back(std::thread([this, &field, &matrix, &x, &y, begin, end] { multiply_rows(field, matrix, x, y, begin, end); }));
+			begin = end;
+		}
+		multiply_rows(field, matrix, x, y, begin, total_var);
+		for (size_t pointer = 0; pointer < worker.size(); pointer++) worker[pointer].join();
+	}
+
+	// sum of a[i] * b[i] for i < size
+	static number dot(const prime_field& field, const number* a, const number* b, size_t size)
+	{
+		size_t limit = field.lazy_limit();
+		unsigned __int128 sum = 0;
+		for (size_t start = 0; start < size; start += limit - 1)
+		{
+			size_t stop = std::min(size, start + limit - 1);
+			for (size_t pointer = start; pointer < stop; pointer++) sum += (unsigned __int128) a[pointer] * b[pointer];
+			sum = field.reduce(sum);
+		}
+		return (number) sum;
+	}
+
+	// Berlekamp-Massey, connection polynomial 1 + c[1]x + ... + c[L]x^L of the sequence
+	std::vector<number> berlekamp_massey(const prime_field& field, const std::vector<number>& sequence) const
+	{
+		std::vector<number> connection(1, 1), previous(1, 1);
+		size_t length = 0, shift = 1;
+		number previous_discrepancy = 1;
+		std::vector<number> reversed(sequence.rbegin(), sequence.rend());
+
+		for (size_t pointer = 0; pointer < sequence.size(); pointer++)
+		{
+			// sequence is read backwards from pointer, so the reversed copy keeps the dot product contiguous
+			number discrepancy = field.add(sequence[pointer], dot(field, connection.data() + 1, reversed.data() + reversed.size() - pointer, length));
+			if (discrepancy == 0)
+			{
+				shift++;
+				continue;
+			}
+
+			std::vector<number> temp(connection);
+			number factor = field.mul(discrepancy, field.inverse(previous_discrepancy));
+			if (connection.size() < previous.size() + shift) connection.resize(previous.size() + shift, 0);
+			for (size_t term = 0; term < previous.size(); term++)
+			{
+				connection[term + shift] = field.sub(connection[term + shift], field.mul(factor, previous[term]));
+			}
+
+			if (2 * length <= pointer)
+			{
+				length = pointer + 1 - length;
+				previous.swap(temp);
+				previous_discrepancy = discrepancy;
+				shift = 1;
+			}
+			else shift++;
+		}
+
+		connection.resize(length + 1, 0);
+		return connection;
+	}
+
+	// solve A x = b modulo the prime of field, false when A cannot be shown to be nonsingular
+	// A is preconditioned as A D with a random diagonal D, so the minimal polynomial of A D is its characteristic
+	// polynomial with high probability; its degree being n with a nonzero constant term proves det(A) != 0
+	bool solve_prime(const prime_field& field, const unsigned long long seed, std::vector<number>& x) const
+	{
+		std::mt19937_64 random(seed);
+		number prime = field.get_prime();
+
+		// residues of the entries do not depend on the attempt, each one costs a modular inverse
+		std::vector<number> residue(value.size()), matrix(value.size()), b(total_var), scale(total_var);
+		for (size_t pointer = 0; pointer < value.size(); pointer++) residue[pointer] = field.residue(value[pointer]);
+		for (size_t pointer = 0; pointer < total_var; pointer++) b[pointer] = field.residue(rhs[pointer]);
+
+		for (size_t attempt = 0; attempt < total_attempt; attempt++)
+		{
+			for (size_t pointer = 0; pointer < total_var; pointer++) scale[pointer] = 1 + random() % (prime - 1);
+			for (size_t pointer = 0; pointer < value.size(); pointer++) matrix[pointer] = field.mul(residue[pointer], scale[col_index[pointer]]);
+
+			// sequence u^T (A D)^i v for i < 2n with random u and v
+			std::vector<number> u(total_var), v(total_var), next(total_var);
+			for (size_t pointer = 0; pointer < total_var; pointer++)
+			{
+				u[pointer] = random() % prime;
+				v[pointer] = random() % prime;
+			}
+			std::vector<number> sequence(2 * total_var);
+			for (size_t term = 0; term < sequence.size(); term++)
+			{
+				sequence[term] = dot(field, u.data(), v.data(), total_var);
+				multiply(field, matrix, v, next);
+				v.swap(next);
+			}
+
+			std::vector<number> connection = berlekamp_massey(field, sequence);
+			size_t length = connection.size() - 1;
+			if (length != total_var || connection[length] == 0) continue;
+
+			// y = -((A D)^(n-1) + c[1](A D)^(n-2) + ... + c[n-1]) b / c[n] by Horner's rule, then x = D y
+			x = b;
+			for (size_t term = 1; term < length; term++)
+			{
+				multiply(field, matrix, x, next);
+				for (size_t pointer = 0; pointer < total_var; pointer++) x[pointer] = field.add(next[pointer], field.mul(connection[term], b[pointer]));
+			}
+			number factor = field.sub(0, field.inverse(connection[length]));
+			for (size_t pointer = 0; pointer < total_var; pointer++) x[pointer] = field.mul(field.mul(x[pointer], factor), scale[pointer]);
+			return true;
+		}
+		return false;
+	}
+
+	// rational number r/s with r = s * target (mod modulus) and |r|, |s| <= INT_MAX
+	static bool reconstruct(const unsigned __int128 target, const unsigned __int128 modulus, fraction& result)
+	{
+		__int128 r0 = modulus, r1 = target, s0 = 0, s1 = 1;
+		while (r1 > INT_MAX)
+		{
+			__int128 quotient = r0 / r1;
+			__int128 r2 = r0 - quotient * r1;
+			__int128 s2 = s0 - quotient * s1;
+			r0 = r1; r1 = r2;
+			s0 = s1; s1 = s2;
+		}
+		if (s1 == 0 || s1 > INT_MAX || s1 < -INT_MAX) return false;
+		if (gcd((long long) r1, (long long) s1) != 1) return false;
+		result = fraction((int) r1, (int) s1);
+		return true;
+	}
+
+	// check the reconstructed solution modulo a third prime
+	bool check_solution(const std::vector<fraction>& solution) const
+	{
+		const prime_field& field = check_field();
+		std::vector<number> matrix(value.size()), x(total_var), y(total_var);
+		for (size_t pointer = 0; pointer < value.size(); pointer++) matrix[pointer] = field.residue(value[pointer]);
+		for (size_t pointer = 0; pointer < total_var; pointer++) x[pointer] = field.residue(solution[pointer]);
+		multiply(field, matrix, x, y);
+		for (size_t pointer = 0; pointer < total_var; pointer++)
+		{
+			if (y[pointer] != field.residue(rhs[pointer])) return false;
+		}
+		return true;
+	}
+public:
+	// default constructor
+	sparse_solver() : total_thread(1), total_var(0), row_start(1, 0) { }
+
+	// modifier
+	// start a square system with n variable(s) and n equation(s)
+	void resize(const size_t n)
+	{
+		total_var = n;
+		row_start.assign(n + 1, 0);
+		col_index.clear();
+		value.clear();
+		entry_row.clear();
+		rhs.assign(n, fraction());
+	}
+
+	void add_entry(const size_t row, const size_t col, const fraction& entry)
+	{
+		if (entry.is_zero()) return;
+		entry_row.push_back(row);
+		col_index.push_back(col);
+		value.push_back(entry);
+	}
+
+	void set_rhs(const size_t row, const fraction& entry)
+	{
+		rhs[row] = entry;
+	}
+
+	// solve the system, true only for a proven nonsingular matrix whose solution fits in int fractions
+	bool solve(std::vector<fraction>& solution)
+	{
+		compress();
+		solution.assign(total_var, fraction());
+		total_thread = std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+
+		// the two primes are independent, so they are solved on two threads
+		std::vector<number> first_x, second_x;
+		bool is_first_solved = false;
+		std::thread first_solver([this, &first_x, &is_first_solved] { is_first_solved = solve_prime(first_field(), 2 * total_var + 1, first_x); });
+		bool is_second_solved = solve_prime(second_field(), 2 * total_var + 2, second_x);
+		first_solver.join();
+		if (!is_first_solved || !is_second_solved) return false;
+
+		// x = first_x + first_prime * k with k = (second_x - first_x) / first_prime modulo second_prime
+		const prime_field& second = second_field();
+		number first_prime = first_field().get_prime();
+		number first_inverse = second.inverse(first_prime % second.get_prime());
+		unsigned __int128 modulus = (unsigned __int128) first_prime * second.get_prime();
+		for (size_t pointer = 0; pointer < total_var; pointer++)
+		{
+			number k = second.mul(second.sub(second_x[pointer], first_x[pointer] % second.get_prime()), first_inverse);
+			unsigned __int128 combined = first_x[pointer] + (unsigned __int128) first_prime * k;
+			if (!reconstruct(combined, modulus, solution[pointer])) return false;
+		}
+		return check_solution(solution);
+	}
+
+	// access
+	// copy the system into a dense augmented matrix
+	void get_dense(std::vector<std::vector<fraction> >& matrix) const
+	{
+		matrix.assign(total_var, std::vector<fraction>(total_var + 1));
+		for (size_t row_pointer = 0; row_pointer < total_var; row_pointer++)
+		{
+			for (size_t pointer = row_start[row_pointer]; pointer < row_start[row_pointer + 1]; pointer++)
+			{
+				matrix[row_pointer][col_index[pointer]] += value[pointer];
+			}
+			matrix[row_pointer][total_var] = rhs[row_pointer];
+		}
+	}
+};
+
+}
+
+#endif
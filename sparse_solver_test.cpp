@@ -0,0 +1,74 @@
+#include <iostream>
+#include <vector>
+#include "sparse_solver.h"
+
+using namespace std;
+
+void print_solution(sic::sparse_solver& solver)
+{
+	vector<sic::fraction> x;
+	if (solver.solve(x))
+	{
+		for (size_t pointer = 0; pointer < x.size(); pointer++)
+		{
+			x[pointer].print();
+			cout << " ";
+		}
+	}
+	else cout << "no unique solution";
+	cout << endl;
+}
+
+int main()
+{
+	// 4x + 5/2z = 7, -3y = 0, 6z = 1
+	sic::sparse_solver s1;
+	s1.resize(3);
+	s1.add_entry(0, 0, sic::fraction(4, 1));
+	s1.add_entry(0, 2, sic::fraction(5, 2));
+	s1.add_entry(1, 1, sic::fraction(-3, 1));
+	s1.add_entry(2, 2, sic::fraction(6, 1));
+	s1.set_rhs(0, sic::fraction(7, 1));
+	s1.set_rhs(2, sic::fraction(1, 1));
+	print_solution(s1);
+
+	// x + y = 1, 2x + 2y = 2 is singular but consistent
+	sic::sparse_solver s2;
+	s2.resize(2);
+	s2.add_entry(0, 0, sic::fraction(1, 1));
+	s2.add_entry(0, 1, sic::fraction(1, 1));
+	s2.add_entry(1, 0, sic::fraction(2, 1));
+	s2.add_entry(1, 1, sic::fraction(2, 1));
+	s2.set_rhs(0, sic::fraction(1, 1));
+	s2.set_rhs(1, sic::fraction(2, 1));
+	print_solution(s2);
+
+	// an empty equation with zero right-hand side
+	sic::sparse_solver s3;
+	s3.resize(3);
+	s3.add_entry(1, 1, sic::fraction(1, 1));
+	s3.add_entry(2, 2, sic::fraction(1, 1));
+	s3.set_rhs(1, sic::fraction(1, 1));
+	s3.set_rhs(2, sic::fraction(2, 1));
+	print_solution(s3);
+
+	// numerators and denominators above 2^30
+	sic::sparse_solver s4;
+	s4.resize(2);
+	s4.add_entry(0, 0, sic::fraction(1, 1));
+	s4.add_entry(1, 1, sic::fraction(2147483646, 1));
+	s4.set_rhs(0, sic::fraction(1500000000, 1));
+	s4.set_rhs(1, sic::fraction(2147483647, 1));
+	print_solution(s4);
+
+	// x = -2147483647 - 1/2147483647 does not fit in int
+	sic::sparse_solver s5;
+	s5.resize(2);
+	s5.add_entry(0, 0, sic::fraction(1, 1));
+	s5.add_entry(0, 1, sic::fraction(1, 1));
+	s5.add_entry(1, 1, sic::fraction(2147483647, 1));
+	s5.set_rhs(0, sic::fraction(-2147483647, 1));
+	s5.set_rhs(1, sic::fraction(1, 1));
+	print_solution(s5);
+	return 0;
+}